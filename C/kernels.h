@@ -0,0 +1,15 @@
+// Shared by the simulation kernels (sim_mem_kernel.h and
+// sim_skip_kernel.h).
+
+#ifndef _KERNELS_H
+#define _KERNELS_H
+
+typedef int (*kernel_t) (const char *, size_t, int, int, int,
+   unsigned long int);
+
+// Largest number of duplicates. The kernels keep their buffers on
+// the stack, about (N+1) * (K+16) bytes, which must also fit in the
+// stack of the worker threads.
+#define MAXN 10000
+
+#endif
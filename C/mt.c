@@ -47,6 +47,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include "mt.h"
 
 //
 // uint32 must be an unsigned integer type capable of holding at least 32
@@ -54,9 +56,9 @@
 // GCC at -O3 optimization so try your options and see what's best for you
 //
 
-typedef unsigned long uint32;
+// uint32 is defined in mt.h.
 
-#define N              (624)                 // length of state vector
+#define N              (MTLEN)               // length of state vector (mt.h)
 #define M              (397)                 // a period parameter
 #define K              (0x9908B0DFU)         // a magic constant
 #define hiBit(u)       ((u) & 0x80000000U)   // mask all but highest   bit of u
@@ -64,9 +66,12 @@ typedef unsigned long uint32;
 #define loBits(u)      ((u) & 0x7FFFFFFFU)   // mask     the highest   bit of u
 #define mixBits(u, v)  (hiBit(u)|loBits(v))  // move hi bit of u to hi bit of v
 
-static uint32   state[N+1];     // state vector + 1 extra to not violate ANSI C
-static uint32   *next;          // next random value is computed from here
-static int      left = -1;      // can *next++ this many times before reloading
+// The state is thread-local so that every thread of the simulators
+// has its own generator (threads that do not call seedMT() all use
+// the same default seed).
+static __thread uint32   state[N+1];     // state vector + 1 extra to not violate ANSI C
+static __thread uint32   *next;          // next random value is computed from here
+static __thread int      left = -1;      // can *next++ this many times before reloading
 
 
 void seedMT(uint32 seed)
@@ -162,3 +167,21 @@ uint32 randomMT(void)
     y ^= (y << 15) & 0xEFC60000U;
     return(y ^ (y >> 18));
  }
+
+
+// Save the state of the generator of the calling thread, so that
+// loadMT() can replay the same numbers.
+void saveMT(stateMT *s)
+ {
+    memcpy(s->state, state, sizeof(state));
+    s->next = next == NULL ? 0 : next - state;
+    s->left = left;
+ }
+
+
+void loadMT(const stateMT *s)
+ {
+    memcpy(state, s->state, sizeof(state));
+    next = state + s->next;
+    left = s->left;
+ }
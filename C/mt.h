@@ -1,3 +1,7 @@
 typedef unsigned long uint32;
+#define MTLEN 624   // length of the state vector of the generator
+typedef struct { uint32 state[MTLEN+1]; int next; int left; } stateMT;
 void seedMT(uint32);
 uint32 randomMT(void);
+void saveMT(stateMT *);
+void loadMT(const stateMT *);
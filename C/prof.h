@@ -0,0 +1,164 @@
+// Optional instrumentation of the simulators.
+//
+// Everything below compiles to nothing unless PROFILE is defined,
+// e.g. gcc -O3 -DPROFILE sim_mem.c mt.c. With PROFILE, the counters
+// and per-phase cycle counts are written to stderr at the end of the
+// run, and a progress line is written every PROF_PERIOD reads.
+// The counters are per thread: worker threads call PROF_MERGE()
+// before they exit to add theirs to the totals of the report.
+//
+// Include after "mt.h" so that calls to randomMT() are counted.
+
+#ifndef _PROF_H
+#define _PROF_H
+
+#ifdef PROFILE
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define prof_cycles() __rdtsc()
+#else
+static inline uint64_t prof_cycles (void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+#endif
+
+#ifndef PROF_PERIOD
+#define PROF_PERIOD 65536
+#endif
+
+// Event counters.
+enum {
+  PROF_RNG,       // Calls to randomMT().
+  PROF_DOMINANT,  // Rescans after the dominant thread falls (MEM seeds).
+  PROF_TAKEOVER,  // Scans for a thread taking over (MEM seeds).
+  PROF_SEED,      // Seed events.
+  PROF_NCOUNT
+};
+
+// Timed phases.
+enum {
+  PROF_CLEAR,     // Erase read, duplicates and scores.
+  PROF_SHUFFLE,   // Draw error positions in the read.
+  PROF_FALLS,     // Mutate duplicates and see which threads fall.
+  PROF_UPDATE,    // Seed checks, streak updates, dominant rescan.
+  PROF_WRAPUP,    // Final scans of seeded duplicates.
+  PROF_NPHASE
+};
+
+static const char * PROF_COUNT_NAME[PROF_NCOUNT] =
+   {"rng draws", "dominant rescans", "takeover scans", "seed events"};
+static const char * PROF_PHASE_NAME[PROF_NPHASE] =
+   {"clear", "shuffle", "falls", "update", "wrapup"};
+
+static __thread uint64_t prof_count[PROF_NCOUNT];
+static __thread uint64_t prof_phase[PROF_NPHASE];
+static __thread uint64_t prof_tic;
+static uint64_t prof_total_count[PROF_NCOUNT];
+static uint64_t prof_total_phase[PROF_NPHASE];
+static pthread_mutex_t prof_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t prof_reads;
+static struct timespec prof_start;
+
+static inline double prof_elapsed (void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - prof_start.tv_sec) +
+     (now.tv_nsec - prof_start.tv_nsec) / 1e9;
+}
+
+static void prof_init (void) {
+  clock_gettime(CLOCK_MONOTONIC, &prof_start);
+}
+
+// Called after 'reads' simulated reads (from the main thread only);
+// 'total' is the expected number of reads or 0 if it is not known
+// (realistic profiles).
+static void prof_progress (size_t reads, size_t total) {
+  uint64_t before = prof_reads;
+  prof_reads += reads;
+  if (prof_reads / PROF_PERIOD == before / PROF_PERIOD) return;
+  double secs = prof_elapsed();
+  double rate = prof_reads / secs;
+  if (total > 0) {
+    fprintf(stderr, "[prof] %lu/%zu reads, %.0f reads/s, ETA %.0f s\n",
+        (unsigned long) prof_reads, total, rate, (total - prof_reads) / rate);
+  }
+  else {
+    fprintf(stderr, "[prof] %lu reads, %.0f reads/s\n",
+        (unsigned long) prof_reads, rate);
+  }
+}
+
+// Add the counts of the calling thread to the totals.
+static void prof_merge (void) {
+  pthread_mutex_lock(&prof_lock);
+  for (int i = 0 ; i < PROF_NCOUNT ; i++) {
+    prof_total_count[i] += prof_count[i];
+    prof_count[i] = 0;
+  }
+  for (int i = 0 ; i < PROF_NPHASE ; i++) {
+    prof_total_phase[i] += prof_phase[i];
+    prof_phase[i] = 0;
+  }
+  pthread_mutex_unlock(&prof_lock);
+}
+
+static void prof_report (void) {
+  prof_merge();
+  double secs = prof_elapsed();
+  uint64_t reads = prof_reads ? prof_reads : 1;
+  uint64_t cycles = 0;
+  for (int i = 0 ; i < PROF_NPHASE ; i++) cycles += prof_total_phase[i];
+  if (cycles == 0) cycles = 1;
+  fprintf(stderr, "[prof] %lu reads in %.2f s (%.0f reads/s)\n",
+      (unsigned long) prof_reads, secs, prof_reads / secs);
+  for (int i = 0 ; i < PROF_NCOUNT ; i++) {
+    fprintf(stderr, "[prof] %-16s %14lu (%.2f per read)\n", PROF_COUNT_NAME[i],
+        (unsigned long) prof_total_count[i],
+        prof_total_count[i] / (double) reads);
+  }
+  for (int i = 0 ; i < PROF_NPHASE ; i++) {
+    fprintf(stderr, "[prof] %-16s %14lu cycles (%5.1f%%)\n", PROF_PHASE_NAME[i],
+        (unsigned long) prof_total_phase[i],
+        100.0 * prof_total_phase[i] / cycles);
+  }
+}
+
+// Count every call to the Mersenne twister (the macro is not
+// expanded recursively, so this calls the real function).
+#define randomMT() (prof_count[PROF_RNG]++, randomMT())
+
+#define PROF_INIT() prof_init()
+#define PROF_COUNT(c) (prof_count[c]++)
+#define PROF_COUNT_IF(cond, c) (prof_count[c] += ((cond) != 0))
+#define PROF_TIC() (prof_tic = prof_cycles())
+#define PROF_TOC(p) do { uint64_t _t = prof_cycles(); \
+   prof_phase[p] += _t - prof_tic; prof_tic = _t; } while (0)
+#define PROF_PROGRESS(total) prof_progress(1, total)
+#define PROF_PROGRESS_N(reads, total) prof_progress(reads, total)
+#define PROF_MERGE() prof_merge()
+#define PROF_REPORT() prof_report()
+
+#else
+
+#define PROF_INIT()
+#define PROF_COUNT(c)
+#define PROF_COUNT_IF(cond, c)
+#define PROF_TIC()
+#define PROF_TOC(p)
+#define PROF_PROGRESS(total)
+#define PROF_PROGRESS_N(reads, total)
+#define PROF_MERGE()
+#define PROF_REPORT()
+
+#endif
+
+#endif
@@ -0,0 +1,220 @@
+// Simulations on realistic error profiles, shared by sim_mem_realistic.c
+// and sim_skip_realistic.c. Include after kernels.h.
+//
+// Usage: sim_*_realistic FILE [R [N [THREADS]]]
+//
+// Every line of FILE is the error profile of a read ('1' at the
+// positions of the sequencing errors). Each profile is parsed once
+// and evaluated against R independent draws of the read and of its
+// N duplicates (default R=1 and N as defined in the calling file, N
+// at most MAXN). With THREADS > 1, the main thread reads the next
+// batch of profiles while the worker threads process the current
+// one. Profiling counts (see prof.h) are kept per thread and added
+// up in the report; the cycle counts are then summed over threads.
+
+#ifndef _REALISTIC_H
+#define _REALISTIC_H
+
+#include <pthread.h>
+
+#define BATCH 4096
+
+struct batch {
+  size_t size;
+  int    E[BATCH];            // Number of errors.
+  char   mask[BATCH][K];      // Error positions.
+};
+
+struct worker {
+  pthread_t thread;
+  int       id;
+  long      total_case_1;
+  long      total_case_2;
+};
+
+// Shared by the main thread and the workers.
+static struct batch        BATCHES[2];
+static struct batch      * current;
+static pthread_barrier_t   start;
+static pthread_barrier_t   done;
+static int                 quit = 0;
+
+static kernel_t            kernel;
+static unsigned long int   m;
+static int                 R = 1;
+static int                 ndup = N;
+static int                 nthreads = 1;
+
+
+// Read the next batch of profiles, return the number of profiles.
+static size_t read_batch (FILE * mutfile, struct batch * b,
+   char ** mut, size_t * sz) {
+
+  ssize_t len;
+  b->size = 0;
+
+  while (b->size < BATCH && (len = getline(mut, sz, mutfile)) != -1) {
+    int E = 0; // Number of errors.
+    char * mask = b->mask[b->size];
+    for (int i = 0 ; i < K ; i++) {
+      mask[i] = i < len && (*mut)[i] == '1';
+      E += mask[i];
+    }
+    b->E[b->size++] = E;
+  }
+
+  return b->size;
+
+}
+
+
+// Evaluate one profile against R draws of the read and its duplicates.
+static void replicate (const char * mask, int E,
+   long * total_case_1, long * total_case_2) {
+
+  char read[K];
+
+  for (int r = 0 ; r < R ; r++) {
+
+    PROF_TIC();
+
+    // Introduce errors in the read.
+    for (int i = 0 ; i < K ; i++) {
+      read[i] = mask[i] ? randombp() : 0;
+    }
+
+    PROF_TOC(PROF_SHUFFLE);
+
+    int outcome = kernel(read, E, K, GAMMA, ndup, m);
+
+    *total_case_1 += outcome == 1;
+    *total_case_2 += outcome == 2;
+
+    PROF_TOC(PROF_WRAPUP);
+
+  }
+
+}
+
+
+static void * work (void * arg) {
+
+  struct worker * w = arg;
+
+  // Every thread has its own random generator.
+  seedMT(123 + w->id);
+
+  while (1) {
+    pthread_barrier_wait(&start);
+    if (quit) break;
+    for (size_t j = w->id - 1 ; j < current->size ; j += nthreads) {
+      replicate(current->mask[j], current->E[j],
+          &w->total_case_1, &w->total_case_2);
+    }
+    pthread_barrier_wait(&done);
+  }
+
+  PROF_MERGE();
+
+  return NULL;
+
+}
+
+
+static int run_realistic (int argc, char **argv,
+   kernel_t seeding) {
+
+  const double mu   = 0.06;
+  m = (mu * 4294967295);
+
+  if (argc < 2) {
+    fprintf(stderr, "argument error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  if (argc > 2) R = atoi(argv[2]);
+  if (argc > 3) ndup = atoi(argv[3]);
+  if (argc > 4) nthreads = atoi(argv[4]);
+
+  if (R < 1 || ndup < 1 || ndup > MAXN || nthreads < 1) {
+    fprintf(stderr, "argument error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  FILE * mutfile = fopen(argv[1], "r");
+  if (mutfile == NULL) {
+     fprintf(stderr, "cannot open file %s\n", argv[1]);
+     exit(EXIT_FAILURE);
+  }
+
+  kernel = seeding;
+
+  // Set the random seed.
+  seedMT(123);
+  PROF_INIT();
+
+  size_t sz = 151;
+  char * mut = malloc(sz);
+
+  long ITER = 0;
+  long total_case_1 = 0;
+  long total_case_2 = 0;
+
+  // Run the simulation.
+  current = BATCHES;
+  read_batch(mutfile, current, &mut, &sz);
+
+  if (nthreads == 1) {
+    while (current->size > 0) {
+      for (size_t j = 0 ; j < current->size ; j++) {
+        replicate(current->mask[j], current->E[j],
+            &total_case_1, &total_case_2);
+      }
+      ITER += current->size * R;
+      PROF_PROGRESS_N(current->size * R, 0);
+      read_batch(mutfile, current, &mut, &sz);
+    }
+  }
+  else {
+    struct worker * workers = calloc(nthreads, sizeof(struct worker));
+    pthread_barrier_init(&start, NULL, nthreads + 1);
+    pthread_barrier_init(&done, NULL, nthreads + 1);
+    for (int t = 0 ; t < nthreads ; t++) {
+      workers[t].id = t + 1;
+      pthread_create(&workers[t].thread, NULL, work, workers + t);
+    }
+    while (current->size > 0) {
+      struct batch * next = current == BATCHES ? BATCHES + 1 : BATCHES;
+      // Read ahead while the workers process the current batch.
+      pthread_barrier_wait(&start);
+      read_batch(mutfile, next, &mut, &sz);
+      pthread_barrier_wait(&done);
+      ITER += current->size * R;
+      PROF_PROGRESS_N(current->size * R, 0);
+      current = next;
+    }
+    quit = 1;
+    pthread_barrier_wait(&start);
+    for (int t = 0 ; t < nthreads ; t++) {
+      pthread_join(workers[t].thread, NULL);
+      total_case_1 += workers[t].total_case_1;
+      total_case_2 += workers[t].total_case_2;
+    }
+    pthread_barrier_destroy(&start);
+    pthread_barrier_destroy(&done);
+    free(workers);
+  }
+
+  free(mut);
+  fclose(mutfile);
+
+  fprintf(stdout, "Case 1: %f Case 2: %f\n",
+      total_case_1 / (float) ITER, total_case_2 / (float) ITER);
+
+  PROF_REPORT();
+
+  return 0;
+
+}
+
+#endif
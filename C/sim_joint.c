@@ -0,0 +1,167 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <time.h>
+#include "mt.h"
+#include "prof.h"
+
+// Joint simulation of MEM, skip and exact seeds on common random
+// numbers: every read and every set of duplicates is used for all
+// three methods, so the paired differences between methods have
+// much smaller variance than differences between separate runs.
+//
+// Usage: sim_joint E [K GAMMA N] (K at most 151, N at most MAXN)
+
+#define ITER 1000000
+#define GAMMA 19
+#define K 100
+#define N 100
+
+#define randombp() (1 + (randomMT() / 1431655765))
+
+#define KERNEL_NAME mem_kernel
+#include "sim_mem_kernel.h"
+
+#define skip 9
+#define KERNEL_NAME skip_kernel
+#include "sim_skip_kernel.h"
+#undef skip
+
+// Exact seeds are skip seeds with skip = 0.
+#define skip 0
+#define KERNEL_NAME exact_kernel
+#include "sim_skip_kernel.h"
+#undef skip
+
+#define NMETHODS 3
+
+static const char * METHOD[NMETHODS] = {"MEM", "skip", "exact"};
+
+static int POS[151] = {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,
+   21,22,23,24,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,
+   45,46,47,48,49,50,51,52,53,54,55,56,57,58,59,60,61,62,63,64,65,66,67,68,
+   69,70,71,72,73,74,75,76,77,78,79,80,81,82,83,84,85,86,87,88,89,90,91,92,
+   93,94,95,96,97,98,99,100,101,102,103,104,105,106,107,108,109,110,111,112,
+   113,114,115,116,117,118,119,120,121,122,123,124,125,126,127,128,129,130,
+   131,132,133,134,135,136,137,138,139,140,141,142,143,144,145,146,147,148,
+   149,150};
+
+int shuffle (const void * a, const void * b) {
+  return (randomMT() < 2147483648) ? -1 : 1;
+}
+
+
+int main(int argc, char **argv) {
+
+  if (argc < 2) {
+    fprintf(stderr, "argument error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  size_t E    = atoi(argv[1]);
+
+  const int k     = argc > 2 ? atoi(argv[2]) : K;
+  const int gamma = argc > 3 ? atoi(argv[3]) : GAMMA;
+  const int n     = argc > 4 ? atoi(argv[4]) : N;
+
+  if (k < 1 || k > 151 || E == 0 || E > k || gamma < 1 ||
+      n < 1 || n > MAXN) {
+    fprintf(stderr, "argument error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  const double mu   = 0.06;
+  const unsigned long int m = (mu   * 4294967295);
+
+  kernel_t kernel[NMETHODS] = {mem_kernel, skip_kernel, exact_kernel};
+
+  // Set the random seed.
+  seedMT(123);
+  PROF_INIT();
+
+  char read[151];
+
+  // Cases 1 and 2 for every method, and sums of the paired
+  // differences and of their squares for every pair of methods.
+  long total[NMETHODS][2] = {{0}};
+  long diff[NMETHODS][NMETHODS][2] = {{{0}}};
+  long diff2[NMETHODS][NMETHODS][2] = {{{0}}};
+
+  // Run the simulation.
+  for (size_t iter = 0 ; iter < ITER ; iter++) {
+
+    PROF_TIC();
+
+    // Erase read.
+    bzero(read, k);
+
+    // Get error positions in the read.
+    qsort(POS, k, sizeof(int), shuffle);
+
+    // Introduce E errors in the read.
+    for (int e = 0 ; e < E ; e++) {
+      read[POS[e]] = randombp();
+    }
+
+    PROF_TOC(PROF_SHUFFLE);
+
+    // All the kernels draw the duplicates in the same order, so
+    // restoring the state of the generator gives every method the
+    // same duplicates. The stream then goes on after the last one.
+    stateMT saved;
+    saveMT(&saved);
+
+    int outcome[NMETHODS];
+    for (int j = 0 ; j < NMETHODS ; j++) {
+      if (j > 0) loadMT(&saved);
+      outcome[j] = kernel[j](read, E, k, gamma, n, m);
+    }
+
+    for (int c = 0 ; c < 2 ; c++) {
+      for (int a = 0 ; a < NMETHODS ; a++) {
+        int x = outcome[a] == c+1;
+        total[a][c] += x;
+        for (int b = a+1 ; b < NMETHODS ; b++) {
+          int d = x - (outcome[b] == c+1);
+          diff[a][b][c] += d;
+          diff2[a][b][c] += d*d;
+        }
+      }
+    }
+
+    PROF_TOC(PROF_WRAPUP);
+    PROF_PROGRESS(ITER);
+
+  }
+
+  // Rates with their standard errors in parentheses.
+  double p[NMETHODS][2];
+  double se[NMETHODS][2];
+  for (int a = 0 ; a < NMETHODS ; a++) {
+    for (int c = 0 ; c < 2 ; c++) {
+      p[a][c] = total[a][c] / (double) ITER;
+      se[a][c] = sqrt(p[a][c] * (1 - p[a][c]) / ITER);
+    }
+    fprintf(stdout, "%s: Case 1: %f (%f) Case 2: %f (%f)\n", METHOD[a],
+        p[a][0], se[a][0], p[a][1], se[a][1]);
+  }
+
+  // Paired differences with their standard errors, and the standard
+  // errors the same differences would have with independent runs.
+  for (int a = 0 ; a < NMETHODS ; a++) {
+    for (int b = a+1 ; b < NMETHODS ; b++) {
+      fprintf(stdout, "%s - %s:", METHOD[a], METHOD[b]);
+      for (int c = 0 ; c < 2 ; c++) {
+        double d = diff[a][b][c] / (double) ITER;
+        double v = diff2[a][b][c] / (double) ITER - d*d;
+        fprintf(stdout, " Case %d: %f (%f, independent %f)", c+1, d,
+            sqrt(v / ITER), sqrt(se[a][c]*se[a][c] + se[b][c]*se[b][c]));
+      }
+      fprintf(stdout, "\n");
+    }
+  }
+
+  PROF_REPORT();
+
+}
@@ -0,0 +1,119 @@
+// MEM seeding kernel, included once for every kernel a file defines.
+//
+// Define KERNEL_NAME (the name of the function) before inclusion.
+// No include guard on purpose.
+
+#include "kernels.h"
+
+// Simulate one read with E errors (non-zero entries of 'read')
+// against ndup duplicates. Return 1 if seeding misses the target
+// (case 1), 2 if a duplicate with fewer errors is also seeded
+// (case 2) and 0 otherwise.
+static int KERNEL_NAME (const char * read, size_t E, int k, int gamma,
+   int ndup, unsigned long int m) {
+
+  char dup[ndup+1][k];
+
+  int  err[ndup+1];         // Total errors.
+  int  str[ndup+1];         // Streak score.
+
+  int  falls[ndup+1];       // Which threads fall.
+  int  has_seed[ndup+1];    // Seeded duplicates.
+
+  // Erase seed info.
+  bzero(has_seed, (ndup+1) * sizeof(int));
+
+  // Erase duplicates.
+  bzero(dup, (ndup+1) * k);
+  bzero(err, (ndup+1) * sizeof(int));
+  bzero(str, (ndup+1) * sizeof(int));
+
+  PROF_TOC(PROF_CLEAR);
+
+  int dominant = 0;
+
+  for (int i = 0 ; i < k ; i++) {
+    // See which threads fall.
+    falls[0] = read[i] != 0;
+    for (int n = 1 ; n < ndup+1; n++) {
+      if (randomMT() < m) dup[n][i] = randombp();
+      falls[n] = dup[n][i] != read[i];
+    }
+    PROF_TOC(PROF_FALLS);
+    // Update.
+    int update_dominant = 0;
+    if (falls[dominant]) {
+      update_dominant = 1;
+      if (str[dominant] >= gamma) {
+        // It's seed time.
+        PROF_COUNT(PROF_TAKEOVER);
+        int another_takes_over = 0;
+        for (int n = 0 ; n < ndup+1 ; n++) {
+          if (str[n] == str[dominant] && !falls[n]) {
+            another_takes_over = 1;
+            break;
+          }
+        }
+        // If another thead takes over, there
+        // is nothing to do. Otherwise, we have
+        // a seed (strict or shared).
+        if (!another_takes_over) {
+          PROF_COUNT(PROF_SEED);
+          for (int n = 0 ; n < ndup+1 ; n++) {
+            if (str[n] == str[dominant]) has_seed[n] = 1;
+          }
+        }
+      }
+    }
+    // Update streaks and errors.
+    for (int n = 0 ; n < ndup+1 ; n++) {
+      if (falls[n]) {
+        str[n] = 0;
+        err[n]++;
+      }
+      else {
+        str[n]++;
+      }
+    }
+    // If required, update dominant.
+    if (update_dominant) {
+      PROF_COUNT(PROF_DOMINANT);
+      dominant = 0;
+      for (int n = 1 ; n < ndup+1 ; n++) {
+        if (str[n] > str[dominant]) dominant = n;
+      }
+    }
+    PROF_TOC(PROF_UPDATE);
+  }
+
+  // Final wrap up.
+  if (str[dominant] >= gamma) {
+    PROF_COUNT(PROF_SEED);
+    for (int n = 0 ; n < ndup+1 ; n++) {
+      if (str[n] == str[dominant]) has_seed[n] = 1;
+    }
+  }
+
+  int there_is_a_better_hit = 0;
+  for (int n = 1 ; n < ndup+1 ; n++) {
+    if (err[n] < E && has_seed[n]) {
+      there_is_a_better_hit = 1;
+      break;
+    }
+  }
+
+  int has_false_hit = 0;
+  for (int n = 0 ; n < ndup+1 ; n++) {
+    if (has_seed[n]){
+      has_false_hit = 1;
+      break;
+    }
+  }
+
+  if (!has_seed[0] && has_false_hit) return 1;
+  if (has_seed[0] && there_is_a_better_hit) return 2;
+  return 0;
+
+}
+
+#undef KERNEL_NAME
@@ -3,6 +3,7 @@
 #include <strings.h>
 #include <time.h>
 #include "mt.h"
+#include "prof.h"
 
 #define ITER 1000000
 #define GAMMA 19
@@ -25,6 +26,9 @@ int shuffle (const void * a, const void * b) {
   return (randomMT() < 2147483648) ? -1 : 1;
 }
 
+#define KERNEL_NAME skip_kernel
+#include "sim_skip_kernel.h"
+
 void print (char * seq) {
   for (int i = 0 ; i < K ; i++) {
     fprintf(stdout, "%d", seq[i]);
@@ -35,12 +39,25 @@ void print (char * seq) {
 
 int main(int argc, char **argv) {
 
+  // Usage: sim_skip E [K GAMMA N]. Parameters that are not
+  // specified take the default values defined above
+  // (K is at most 151 and N at most MAXN).
+  if (argc < 2) {
+    fprintf(stderr, "argument error\n");
+    exit(EXIT_FAILURE);
+  }
+
 //  char **ignore;
 //
   size_t E    = atoi(argv[1]);
 //  double prob = strtod(argv[2], ignore); // p
 //
-  if (E == 0) {
+  const int k     = argc > 2 ? atoi(argv[2]) : K;
+  const int gamma = argc > 3 ? atoi(argv[3]) : GAMMA;
+  const int n     = argc > 4 ? atoi(argv[4]) : N;
+
+  if (k < 1 || k > 151 || E == 0 || E > k || gamma < 1 ||
+      n < 1 || n > MAXN) {
     fprintf(stderr, "argument error\n");
     exit(EXIT_FAILURE);
   }
@@ -53,14 +70,9 @@ int main(int argc, char **argv) {
 
   // Set the random seed.
   seedMT(123);
+  PROF_INIT();
 
-  char dup[N+1][K] = {0};
-  char * read = dup[0];
-
-  int  err[N+1] = {0};      // Total errors.
-  int  str[N+1] = {0};      // Streak score.
-
-  int  has_seed[N+1] = {0}; // Seeded duplicates.
+  char read[151];
 
   int total_case_1 = 0;
   int total_case_2 = 0;
@@ -68,72 +80,34 @@ int main(int argc, char **argv) {
   // Run the simulation.
   for (size_t iter = 0 ; iter < ITER ; iter++) {
 
-    // Erase seed info.
-    bzero(has_seed, (N+1) * sizeof(int));
-    
-    // Erase read and duplicates.
-    bzero(dup, (N+1) * K);
-    bzero(err, (N+1) * sizeof(int));
-    bzero(str, (N+1) * sizeof(int));
+    PROF_TIC();
+
+    // Erase read.
+    bzero(read, k);
 
     // Get error positions in the read.
-    qsort(POS, K, sizeof(int), shuffle);
+    qsort(POS, k, sizeof(int), shuffle);
 
     // Introduce E errors in the read.
     for (int e = 0 ; e < E ; e++) {
       read[POS[e]] = randombp();
     }
 
-    for (int i = 0 ; i < K ; i++) {
-      if (read[i] != 0) {
-        str[0] = (i % (skip+1)) - skip;
-        err[0]++;
-      }
-      else {
-        str[0]++;
-      }
-      for (int n = 1 ; n < N+1; n++) {
-        if (randomMT() < m) dup[n][i] = randombp();
-        if (dup[n][i] != read[i]) {
-          str[n] = (i % (skip+1)) - skip;
-          err[n]++;
-        }
-        else {
-          str[n]++;
-        }
-      }
-      // Check seeds.
-      for (int n = 0 ; n < N+1 ; n++) {
-        if (str[n] >= GAMMA) has_seed[n] = 1;
-      }
-    }
+    PROF_TOC(PROF_SHUFFLE);
 
-    int there_is_a_better_hit = 0;
-    for (int n = 1 ; n < N+1 ; n++) {
-      if (err[n] < E && has_seed[n]) {
-        there_is_a_better_hit = 1;
-//           for (int n = 0 ; n < N+1 ; n++) {
-//             print(dup[n]);
-//           }
-//           fprintf(stdout, "---\n");
-        break;
-      }
-    }
+    int outcome = skip_kernel(read, E, k, gamma, n, m);
 
-    int has_false_hit = 0;
-    for (int n = 0 ; n < N+1 ; n++) {
-      if (has_seed[n]){
-        has_false_hit = 1;
-        break;
-      }
-    }
+    total_case_1 += outcome == 1;
+    total_case_2 += outcome == 2;
 
-    total_case_1 += !has_seed[0] && has_false_hit;
-    total_case_2 += has_seed[0] && there_is_a_better_hit;
+    PROF_TOC(PROF_WRAPUP);
+    PROF_PROGRESS(ITER);
 
   }
 
   fprintf(stdout, "Case 1: %f Case 2: %f\n",
       total_case_1 / (float) ITER, total_case_2 / (float) ITER);
 
+  PROF_REPORT();
+
 }
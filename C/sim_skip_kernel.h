@@ -0,0 +1,81 @@
+// Skip seeding kernel, included once for every kernel a file defines.
+//
+// Define KERNEL_NAME (the name of the function) before inclusion.
+// No include guard on purpose.
+
+#include "kernels.h"
+
+// Simulate one read with E errors (non-zero entries of 'read')
+// against ndup duplicates. Return 1 if seeding misses the target
+// (case 1), 2 if a duplicate with fewer errors is also seeded
+// (case 2) and 0 otherwise.
+static int KERNEL_NAME (const char * read, size_t E, int k, int gamma,
+   int ndup, unsigned long int m) {
+
+  char dup[ndup+1][k];
+
+  int  err[ndup+1];         // Total errors.
+  int  str[ndup+1];         // Streak score.
+
+  int  has_seed[ndup+1];    // Seeded duplicates.
+
+  // Erase seed info.
+  bzero(has_seed, (ndup+1) * sizeof(int));
+
+  // Erase duplicates.
+  bzero(dup, (ndup+1) * k);
+  bzero(err, (ndup+1) * sizeof(int));
+  bzero(str, (ndup+1) * sizeof(int));
+
+  PROF_TOC(PROF_CLEAR);
+
+  for (int i = 0 ; i < k ; i++) {
+    if (read[i] != 0) {
+      str[0] = (i % (skip+1)) - skip;
+      err[0]++;
+    }
+    else {
+      str[0]++;
+    }
+    for (int n = 1 ; n < ndup+1; n++) {
+      if (randomMT() < m) dup[n][i] = randombp();
+      if (dup[n][i] != read[i]) {
+        str[n] = (i % (skip+1)) - skip;
+        err[n]++;
+      }
+      else {
+        str[n]++;
+      }
+    }
+    PROF_TOC(PROF_FALLS);
+    // Check seeds.
+    for (int n = 0 ; n < ndup+1 ; n++) {
+      if (str[n] >= gamma) has_seed[n] = 1;
+      PROF_COUNT_IF(str[n] == gamma, PROF_SEED);
+    }
+    PROF_TOC(PROF_UPDATE);
+  }
+
+  int there_is_a_better_hit = 0;
+  for (int n = 1 ; n < ndup+1 ; n++) {
+    if (err[n] < E && has_seed[n]) {
+      there_is_a_better_hit = 1;
+      break;
+    }
+  }
+
+  int has_false_hit = 0;
+  for (int n = 0 ; n < ndup+1 ; n++) {
+    if (has_seed[n]){
+      has_false_hit = 1;
+      break;
+    }
+  }
+
+  if (!has_seed[0] && has_false_hit) return 1;
+  if (has_seed[0] && there_is_a_better_hit) return 2;
+  return 0;
+
+}
+
+#undef KERNEL_NAME
@@ -0,0 +1,234 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include "mt.h"
+#include "prof.h"
+
+// Stratified simulation over the number of errors in the read.
+//
+// Usage: sim_strata METHOD ITER p1[,p2,...] [K GAMMA N]
+//
+// METHOD is mem, skip or exact; K GAMMA N take the default values
+// defined below if they are not specified (K is at most 151 and N
+// at most MAXN). The reads are simulated in strata of E = 1..K
+// errors and the probabilities of case 1 and case 2 are estimated
+// for every per-base error rate p1, p2, ... by weighting
+// the strata with their binomial probabilities (E = 0 never gives
+// case 1 or case 2). A pilot run uses a tenth of the ITER reads,
+// the rest is allocated to the strata in proportion to their weight
+// times their estimated standard deviation (Neyman allocation). The
+// weight of a stratum is its largest binomial probability over the
+// requested error rates, so that the same strata serve the whole
+// curve. Strata with a weight below MINWEIGHT are not simulated.
+
+#define GAMMA 19
+#define K 100
+#define N 100
+
+#define MINWEIGHT 1e-9
+
+#define randombp() (1 + (randomMT() / 1431655765))
+
+#define KERNEL_NAME mem_kernel
+#include "sim_mem_kernel.h"
+
+#define skip 9
+#define KERNEL_NAME skip_kernel
+#include "sim_skip_kernel.h"
+#undef skip
+
+// Exact seeds are skip seeds with skip = 0.
+#define skip 0
+#define KERNEL_NAME exact_kernel
+#include "sim_skip_kernel.h"
+#undef skip
+
+static int POS[151] = {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,
+   21,22,23,24,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,
+   45,46,47,48,49,50,51,52,53,54,55,56,57,58,59,60,61,62,63,64,65,66,67,68,
+   69,70,71,72,73,74,75,76,77,78,79,80,81,82,83,84,85,86,87,88,89,90,91,92,
+   93,94,95,96,97,98,99,100,101,102,103,104,105,106,107,108,109,110,111,112,
+   113,114,115,116,117,118,119,120,121,122,123,124,125,126,127,128,129,130,
+   131,132,133,134,135,136,137,138,139,140,141,142,143,144,145,146,147,148,
+   149,150};
+
+int shuffle (const void * a, const void * b) {
+  return (randomMT() < 2147483648) ? -1 : 1;
+}
+
+// Per-stratum results.
+static long ITERS[151+1];
+static long CASE_1[151+1];
+static long CASE_2[151+1];
+
+// Binomial probability of E errors in k nucleotides.
+double dbinom (int E, int k, double p) {
+  return exp(lgamma(k+1) - lgamma(E+1) - lgamma(k-E+1) +
+      E * log(p) + (k-E) * log1p(-p));
+}
+
+// Simulate 'iter' reads of size k with E errors.
+void simulate (kernel_t kernel, size_t E, long iter, int k, int gamma,
+   int n, unsigned long int m) {
+
+  char read[151];
+
+  for (long i = 0 ; i < iter ; i++) {
+
+    PROF_TIC();
+
+    // Erase read.
+    bzero(read, k);
+
+    // Get error positions in the read.
+    qsort(POS, k, sizeof(int), shuffle);
+
+    // Introduce E errors in the read.
+    for (int e = 0 ; e < E ; e++) {
+      read[POS[e]] = randombp();
+    }
+
+    PROF_TOC(PROF_SHUFFLE);
+
+    int outcome = kernel(read, E, k, gamma, n, m);
+
+    CASE_1[E] += outcome == 1;
+    CASE_2[E] += outcome == 2;
+
+    PROF_TOC(PROF_WRAPUP);
+    PROF_PROGRESS(0);
+
+  }
+
+  ITERS[E] += iter;
+
+}
+
+
+int main(int argc, char **argv) {
+
+  if (argc < 4) {
+    fprintf(stderr, "argument error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  kernel_t kernel;
+  if (strcmp(argv[1], "mem") == 0) {
+    kernel = mem_kernel;
+  }
+  else if (strcmp(argv[1], "skip") == 0) {
+    kernel = skip_kernel;
+  }
+  else if (strcmp(argv[1], "exact") == 0) {
+    kernel = exact_kernel;
+  }
+  else {
+    fprintf(stderr, "argument error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  const long ITER = atol(argv[2]);
+
+  // Comma-separated error rates.
+  int nrates = 1;
+  for (char * c = argv[3] ; *c ; c++) nrates += *c == ',';
+  double * rate = malloc(nrates * sizeof(double));
+  char * p = argv[3];
+  for (int r = 0 ; r < nrates ; r++) {
+    rate[r] = strtod(p, &p);
+    if (rate[r] <= 0 || rate[r] >= 1 || *p != (r < nrates-1 ? ',' : '\0')) {
+      fprintf(stderr, "argument error\n");
+      exit(EXIT_FAILURE);
+    }
+    p++;
+  }
+
+  const int k     = argc > 4 ? atoi(argv[4]) : K;
+  const int gamma = argc > 5 ? atoi(argv[5]) : GAMMA;
+  const int n     = argc > 6 ? atoi(argv[6]) : N;
+
+  if (ITER < 1 || k < 1 || k > 151 || gamma < 1 || n < 1 || n > MAXN) {
+    fprintf(stderr, "argument error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  const double mu   = 0.06;
+  const unsigned long int m = (mu   * 4294967295);
+
+  // Set the random seed.
+  seedMT(123);
+  PROF_INIT();
+
+  // Weights of the strata.
+  double weight[151+1] = {0};
+  int nstrata = 0;
+  for (int E = 1 ; E < k+1 ; E++) {
+    for (int r = 0 ; r < nrates ; r++) {
+      double w = dbinom(E, k, rate[r]);
+      if (w > weight[E]) weight[E] = w;
+    }
+    if (weight[E] < MINWEIGHT) weight[E] = 0;
+    else nstrata++;
+  }
+
+  if (nstrata == 0) {
+    fprintf(stderr, "error rates too low\n");
+    exit(EXIT_FAILURE);
+  }
+
+  // Pilot run.
+  const long pilot = ITER / 10 / nstrata > 1 ? ITER / 10 / nstrata : 1;
+  for (int E = 1 ; E < k+1 ; E++) {
+    if (weight[E] > 0) simulate(kernel, E, pilot, k, gamma, n, m);
+  }
+
+  // Neyman allocation of the other reads. The probability of
+  // being off target is smoothed so that no stratum is left out
+  // when the pilot run does not see any event.
+  double alloc[151+1] = {0};
+  double total = 0;
+  for (int E = 1 ; E < k+1 ; E++) {
+    if (weight[E] == 0) continue;
+    double q = (CASE_1[E] + CASE_2[E] + 1) / (double) (ITERS[E] + 2);
+    alloc[E] = weight[E] * sqrt(q * (1-q));
+    total += alloc[E];
+  }
+  const long rest = ITER - pilot * nstrata;
+  for (int E = 1 ; E < k+1 ; E++) {
+    long iter = rest > 0 ? rest * alloc[E] / total : 0;
+    if (iter > 0) simulate(kernel, E, iter, k, gamma, n, m);
+  }
+
+  // Per-stratum results, from which the curve can be
+  // computed for any other error rate.
+  for (int E = 1 ; E < k+1 ; E++) {
+    if (ITERS[E] == 0) continue;
+    fprintf(stdout, "E=%d Reads: %ld Case 1: %f Case 2: %f\n", E, ITERS[E],
+        CASE_1[E] / (float) ITERS[E], CASE_2[E] / (float) ITERS[E]);
+  }
+
+  // Stratified estimates with their standard errors in parentheses.
+  for (int r = 0 ; r < nrates ; r++) {
+    double p1 = 0, p2 = 0, v1 = 0, v2 = 0;
+    for (int E = 1 ; E < k+1 ; E++) {
+      if (ITERS[E] == 0) continue;
+      double w = dbinom(E, k, rate[r]);
+      double q1 = CASE_1[E] / (double) ITERS[E];
+      double q2 = CASE_2[E] / (double) ITERS[E];
+      p1 += w * q1;
+      p2 += w * q2;
+      v1 += w * w * q1 * (1-q1) / ITERS[E];
+      v2 += w * w * q2 * (1-q2) / ITERS[E];
+    }
+    fprintf(stdout, "p=%f Case 1: %f (%f) Case 2: %f (%f)\n", rate[r],
+        p1, sqrt(v1), p2, sqrt(v2));
+  }
+
+  free(rate);
+
+  PROF_REPORT();
+
+}